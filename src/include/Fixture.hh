@@ -1,8 +1,10 @@
 #ifndef TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_FIXTURE_HH_
 #define TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_FIXTURE_HH_
 
+#include <array>
 #include <iostream>
 
+#include "Summary.hh"
 #include "Team.hh"
 
 /******************************************************************************
@@ -17,9 +19,19 @@ struct Fixture
     Team& b;
     // Whether the first team won the fixture.
     bool ordered;
+    // Whether the fixture was tied or drawn or similar. (Only completed
+    // fixtures can have this result.)
+    bool drawn;
     // Indicates that the result of this fixture does not affect our favourite
     // team's position.
     bool inconsequential;
+    // Scenarios in which the second team wins and in which the first team
+    // wins, respectively.
+    std::array<Summary, 2> summaries;
+    // How much the result of this fixture affects whether our favourite team
+    // qualifies, with ties broken in their favour and against them,
+    // respectively.
+    std::array<double, 2> influence;
 
     Fixture(Team& a, Team& b);
 };
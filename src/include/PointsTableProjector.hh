@@ -1,30 +1,60 @@
 #ifndef TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_POINTSTABLEPROJECTOR_HH_
 #define TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_POINTSTABLEPROJECTOR_HH_
 
+#include <array>
 #include <cstddef>
+#include <functional>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Fixture.hh"
+#include "Prospect.hh"
+#include "Standings.hh"
+#include "Summary.hh"
 #include "Team.hh"
 
 class PointsTableProjector
 {
 public:
     PointsTableProjector(char const* fname, bool raw_output);
-    void dump(void);
+    void add_tie_breaker(std::function<int(Team const&, Team const&)> tie_breaker);
+    void add_head_to_head(void);
+    void dump(std::array<int, 2> const& ranks, std::vector<int> const& precedence);
     void solve(void);
+    void distribute(void);
+    void timeline(void);
+    void influence(void);
+
+private:
+    // Qualification status of a team.
+    enum Status { undecided, clinched, eliminated };
 
 private:
     void parse(void);
     void parse_points(std::ifstream& fhandle);
     void parse_favourite_team(std::ifstream& fhandle);
+    void parse_places(std::ifstream& fhandle);
     void parse_points_table(std::ifstream& fhandle);
     void parse_fixture(std::ifstream& fhandle, bool completed);
     std::size_t tname_to_tid(std::string const& tname);
-    void solve_(std::size_t idx);
-    void solve__(std::size_t idx, Team& winner, Team& loser);
+    std::array<int, 2> rank(std::vector<int>* precedence);
+    int tie_break(Team const& team);
+    int head_to_head(Team const& a, Team const& b);
+    Summary solve_(std::size_t idx);
+    Summary solve__(std::size_t idx, Team& winner, Team& loser);
+    std::vector<std::pair<long long, double>> distribute_(
+        std::size_t tid, std::vector<int> const& points, std::vector<Fixture const*> const& fixtures, bool draws,
+        bool optimistic
+    );
+    Status qualification(
+        Prospect& inside, Prospect& outside, Standings const& standings, std::vector<Fixture const*> const& fixtures
+    );
+    bool possible(Prospect& prospect, Standings const& standings, std::vector<Fixture const*> const& fixtures);
+    bool search(
+        Prospect& prospect, Standings& standings, std::vector<Fixture const*> const& fixtures, long long& budget
+    );
 
 private:
     char const* fname;
@@ -34,11 +64,27 @@ private:
     int points_other;
     std::string favourite_tname;
     std::size_t favourite_tid;
+    // Number of teams which qualify (if specified).
+    int places;
     // Mapping between team names and team IDs.
     std::unordered_map<std::string, std::size_t const> tname_tid;
     std::vector<Team> teams;
-    // Upcoming fixtures. (Completed fixtures are not stored.)
+    // Completed fixtures, in the order they were played. (Their results are
+    // also included in the points of the teams.)
+    std::vector<Fixture> completed_fixtures;
     std::vector<Fixture> upcoming_fixtures;
+    // Functions which decide whether our favourite team (the first argument)
+    // finishes above or below a team with the same points (the second
+    // argument), consulted in order.
+    std::vector<std::function<int(Team const&, Team const&)>> tie_breakers;
+    // Net number of completed fixtures won by each team against each other
+    // team. (Only filled in if the head-to-head record is a tie-breaker.)
+    std::vector<std::vector<int>> completed_head_to_head;
+    // Whether to display every scenario found while solving.
+    bool show_scenarios;
+    // Placement of teams with the same points as our favourite team in the
+    // scenario being displayed. (Kept here so that it is allocated only once.)
+    std::vector<int> precedence;
     // Output decorations.
     char const* box_horizontal;
     char const* box_up_right;
@@ -0,0 +1,30 @@
+#ifndef TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_PROSPECT_HH_
+#define TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_PROSPECT_HH_
+
+#include <cstddef>
+#include <set>
+#include <vector>
+
+/******************************************************************************
+ * Store what is known about whether a team can finish inside (or outside) the
+ * qualifying places, so that it need not be worked out again after every
+ * fixture.
+ *****************************************************************************/
+struct Prospect
+{
+    std::size_t tid;
+    // Whether this is about finishing inside the qualifying places (instead
+    // of outside).
+    bool qualified;
+    // Results of the fixtures in a scenario in which it happens. Only those
+    // from the given index onwards are meaningful. (Empty if no such scenario
+    // is known.)
+    std::vector<int> witness;
+    std::size_t idx;
+    // Partial scenarios from which it cannot happen.
+    std::set<std::vector<int>> dead_ends;
+
+    Prospect(std::size_t tid, bool qualified);
+};
+
+#endif  // TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_PROSPECT_HH_
@@ -0,0 +1,29 @@
+#ifndef TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_STANDINGS_HH_
+#define TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_STANDINGS_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include "Fixture.hh"
+
+/******************************************************************************
+ * Store the state of a tournament partway through a sequence of fixtures.
+ *****************************************************************************/
+struct Standings
+{
+    // Points of each team.
+    std::vector<int> points;
+    // Number of remaining fixtures of each team, and between each pair of
+    // teams.
+    std::vector<int> remaining;
+    std::vector<std::vector<int>> between;
+    // Index of the first remaining fixture in the sequence.
+    std::size_t idx;
+
+    Standings(std::size_t teams_size);
+    void schedule(Fixture const& fixture);
+    void play(Fixture const& fixture, int points_a, int points_b);
+    void undo(Fixture const& fixture, int points_a, int points_b);
+};
+
+#endif  // TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_STANDINGS_HH_
@@ -0,0 +1,23 @@
+#ifndef TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_SUMMARY_HH_
+#define TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_SUMMARY_HH_
+
+#include <array>
+
+/******************************************************************************
+ * Store information about a group of scenarios.
+ *****************************************************************************/
+struct Summary
+{
+    long long scenarios;
+    // Number of scenarios in which our favourite team qualifies with ties
+    // broken in their favour and against them, respectively.
+    std::array<long long, 2> qualified;
+    // Best and worst rank of our favourite team over these scenarios.
+    int best_rank;
+    int worst_rank;
+
+    Summary(void);
+    void merge(Summary const& summary);
+};
+
+#endif  // TFPF_POINTS_TABLE_PROJECTOR_SRC_INCLUDE_SUMMARY_HH_
@@ -9,7 +9,7 @@
  * @param a
  * @param b
  *****************************************************************************/
-Fixture::Fixture(Team& a, Team& b) : a(a), b(b), ordered(false), inconsequential(false)
+Fixture::Fixture(Team& a, Team& b) : a(a), b(b), ordered(false), drawn(false), inconsequential(false), influence()
 {
 }
 
@@ -22,7 +22,11 @@ Fixture::Fixture(Team& a, Team& b) : a(a), b(b), ordered(false), inconsequential
 std::ostream&
 operator<<(std::ostream& ostream, Fixture const& fixture)
 {
-    if (fixture.ordered)
+    if (fixture.drawn)
+    {
+        ostream << fixture.a.tname << '=' << fixture.b.tname;
+    }
+    else if (fixture.ordered)
     {
         ostream << fixture.a.tname << ',' << fixture.b.tname;
     }
@@ -1,17 +1,25 @@
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <map>
 #include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "Fixture.hh"
 #include "PointsTableProjector.hh"
+#include "Prospect.hh"
+#include "Standings.hh"
+#include "Summary.hh"
 #include "Team.hh"
 
 #define CLOG(...) clog(__FILE__, __LINE__, __VA_ARGS__)
@@ -41,9 +49,9 @@ clog(char const* _file_, int _line_, char const* fmt, Args&&... args)
  * @param raw_output Whether to show plain output (i.e. without colours).
  *****************************************************************************/
 PointsTableProjector::PointsTableProjector(char const* fname, bool raw_output) :
-    fname(fname), line_number(0), points_win(2), points_loss(0), points_other(1), box_horizontal("─"),
-    box_up_right("└"), box_vertical("│"), box_vertical_right("├"), inconsequential_begin("\e[90m"),
-    inconsequential_end("\e[m"), section_begin("[\e[92m"), section_end("\e[m]")
+    fname(fname), line_number(0), points_win(2), points_loss(0), points_other(1), places(0), show_scenarios(true),
+    box_horizontal("─"), box_up_right("└"), box_vertical("│"), box_vertical_right("├"),
+    inconsequential_begin("\e[90m"), inconsequential_end("\e[m"), section_begin("[\e[92m"), section_end("\e[m]")
 {
     // Prevent reallocation in this member, because we are going to store
     // references to its elements in another member.
@@ -58,6 +66,47 @@ PointsTableProjector::PointsTableProjector(char const* fname, bool raw_output) :
     }
 }
 
+/******************************************************************************
+ * Register a tie-breaker. Tie-breakers are consulted in the order they were
+ * registered, until one of them separates our favourite team from a team with
+ * the same points.
+ *
+ * @param tie_breaker Function which, given our favourite team and a team with
+ *     the same points, returns a positive number if our favourite team
+ *     finishes above, a negative number if it finishes below, or zero if that
+ *     cannot be determined.
+ *****************************************************************************/
+void
+PointsTableProjector::add_tie_breaker(std::function<int(Team const&, Team const&)> tie_breaker)
+{
+    this->tie_breakers.push_back(tie_breaker);
+}
+
+/******************************************************************************
+ * Register the head-to-head record as a tie-breaker.
+ *****************************************************************************/
+void
+PointsTableProjector::add_head_to_head(void)
+{
+    // The completed fixtures are the same in every scenario, so tally their
+    // results only once.
+    this->completed_head_to_head.assign(this->teams.size(), std::vector<int>(this->teams.size(), 0));
+    for (Fixture const& fixture : this->completed_fixtures)
+    {
+        if (!fixture.drawn)
+        {
+            ++this->completed_head_to_head[fixture.a.tid][fixture.b.tid];
+            --this->completed_head_to_head[fixture.b.tid][fixture.a.tid];
+        }
+    }
+    this->add_tie_breaker(
+        [this](Team const& a, Team const& b)
+        {
+            return this->head_to_head(a, b);
+        }
+    );
+}
+
 /******************************************************************************
  * Read the contents of the input file and initialise all members accordingly.
  *****************************************************************************/
@@ -84,7 +133,8 @@ PointsTableProjector::parse(void)
         if (line[0] != '[' || line[line.size() - 1] != ']')
         {
             CLOG(
-                "Expected '[points]', '[team]', '[table]', '[completed]' or '[upcoming]' in %s:%d. Found '%s'.",
+                "Expected '[points]', '[team]', '[places]', '[table]', '[completed]' or '[upcoming]' in %s:%d. Found "
+                "'%s'.",
                 this->fname, this->line_number, line.c_str()
             );
             throw std::runtime_error("parse failure");
@@ -109,6 +159,11 @@ PointsTableProjector::parse(void)
             this->parse_favourite_team(fhandle);
             continue;
         }
+        if (line == "places")
+        {
+            this->parse_places(fhandle);
+            continue;
+        }
         if (line == "table")
         {
             if (!this->teams.empty())
@@ -151,7 +206,8 @@ PointsTableProjector::parse(void)
             continue;
         }
         CLOG(
-            "Expected '[points]', '[team]', '[table]', '[completed]' or '[upcoming]' in %s:%d. Found '%s'.",
+            "Expected '[points]', '[team]', '[places]', '[table]', '[completed]' or '[upcoming]' in %s:%d. Found "
+            "'%s'.",
             this->fname, this->line_number, line.c_str()
         );
         throw std::runtime_error("parse failure");
@@ -163,11 +219,6 @@ PointsTableProjector::parse(void)
         throw std::runtime_error("parse failure");
     }
     this->favourite_tid = this->tname_to_tid(this->favourite_tname);
-    if (this->upcoming_fixtures.empty())
-    {
-        CLOG("'[upcoming]' not specified in %s.", this->fname);
-        throw std::runtime_error("parse failure");
-    }
 }
 
 /******************************************************************************
@@ -246,6 +297,34 @@ PointsTableProjector::parse_favourite_team(std::ifstream& fhandle)
     CLOG("Set favourite team to '%s'.", this->favourite_tname.c_str());
 }
 
+/******************************************************************************
+ * Note the number of teams which qualify.
+ *
+ * @param fhandle Stream to read from.
+ *****************************************************************************/
+void
+PointsTableProjector::parse_places(std::ifstream& fhandle)
+{
+    CLOG("Parsing '[places]'.");
+    std::string line;
+    while (std::getline(fhandle, line))
+    {
+        ++this->line_number;
+        if (line.empty())
+        {
+            break;
+        }
+        std::istringstream line_stream(line);
+        line_stream >> this->places;
+        if (line_stream.fail() || this->places <= 0)
+        {
+            CLOG("Expected a positive integer in %s:%d. Found '%s'.", this->fname, this->line_number, line.c_str());
+            throw std::runtime_error("parse failure");
+        }
+    }
+    CLOG("Set number of teams which qualify to %d.", this->places);
+}
+
 /******************************************************************************
  * Note the current standings in the tournament.
  *
@@ -318,16 +397,20 @@ PointsTableProjector::parse_fixture(std::ifstream& fhandle, bool completed)
         std::size_t tid2 = this->tname_to_tid(line.substr(idx + 1, std::string::npos));
         if (completed)
         {
+            Fixture fixture(this->teams[tid1], this->teams[tid2]);
             if (line[idx] == '=')
             {
+                fixture.drawn = true;
                 this->teams[tid1].points += this->points_other;
                 this->teams[tid2].points += this->points_other;
             }
             else
             {
+                fixture.ordered = true;
                 this->teams[tid1].points += this->points_win;
                 this->teams[tid2].points += this->points_loss;
             }
+            this->completed_fixtures.push_back(fixture);
         }
         else
         {
@@ -361,31 +444,131 @@ PointsTableProjector::tname_to_tid(std::string const& tname)
     return tname_tid_it->second;
 }
 
+/******************************************************************************
+ * Calculate the rank of our favourite team. Teams with the same points as our
+ * favourite team are separated using the tie-breakers. If they still cannot be
+ * separated, they are placed below our favourite team for the best rank, and
+ * above it for the worst rank.
+ *
+ * @param precedence Where to note, for each team with the same points as our
+ *     favourite team, whether it is placed above (1) or below (-1) our
+ *     favourite team in the table. Other entries are set to 0. (May be
+ *     `NULL` if this is not needed.)
+ *
+ * @return Best and worst rank.
+ *****************************************************************************/
+std::array<int, 2>
+PointsTableProjector::rank(std::vector<int>* precedence)
+{
+    if (precedence != NULL)
+    {
+        precedence->assign(this->teams.size(), 0);
+    }
+    Team const& favourite = this->teams[this->favourite_tid];
+    std::array<int, 2> ranks = { { 1, 1 } };
+    for (Team const& team : this->teams)
+    {
+        if (team.tid == this->favourite_tid || team.points < favourite.points)
+        {
+            continue;
+        }
+        if (team.points > favourite.points)
+        {
+            ++ranks[0];
+            ++ranks[1];
+            continue;
+        }
+        int comparison = this->tie_break(team);
+        if (precedence != NULL)
+        {
+            (*precedence)[team.tid] = comparison < 0 ? 1 : -1;
+        }
+        ranks[0] += comparison < 0;
+        ranks[1] += comparison <= 0;
+    }
+    return ranks;
+}
+
+/******************************************************************************
+ * Consult the tie-breakers in order until one of them separates our favourite
+ * team from a team with the same points.
+ *
+ * @param team
+ *
+ * @return Positive number if our favourite team finishes above, negative
+ *     number if it finishes below, and zero if the tie-breakers cannot tell.
+ *****************************************************************************/
+int
+PointsTableProjector::tie_break(Team const& team)
+{
+    for (auto const& tie_breaker : this->tie_breakers)
+    {
+        int comparison = tie_breaker(this->teams[this->favourite_tid], team);
+        if (comparison != 0)
+        {
+            return comparison;
+        }
+    }
+    return 0;
+}
+
+/******************************************************************************
+ * Compare the results of the fixtures played between two teams with the same
+ * points. These include the upcoming fixtures, as simulated.
+ *
+ * @param a
+ * @param b
+ *
+ * @return Positive number if the first team won more of them, negative number
+ *     if the second team did, and zero if neither did or if other teams have
+ *     the same points as well.
+ *****************************************************************************/
+int
+PointsTableProjector::head_to_head(Team const& a, Team const& b)
+{
+    // The head-to-head record of only these two teams cannot separate them
+    // from other teams with the same points.
+    for (Team const& team : this->teams)
+    {
+        if (team.tid != a.tid && team.tid != b.tid && team.points == a.points)
+        {
+            return 0;
+        }
+    }
+    int comparison = this->completed_head_to_head[a.tid][b.tid];
+    for (Fixture const& fixture : this->upcoming_fixtures)
+    {
+        if ((fixture.a.tid == a.tid && fixture.b.tid == b.tid) || (fixture.a.tid == b.tid && fixture.b.tid == a.tid))
+        {
+            Team const& winner = fixture.ordered ? fixture.a : fixture.b;
+            comparison += winner.tid == a.tid ? 1 : -1;
+        }
+    }
+    return comparison;
+}
+
 /******************************************************************************
  * Display some members in readable form.
+ *
+ * @param ranks Best and worst rank of our favourite team.
+ * @param precedence Placement of teams with the same points as our favourite
+ *     team, as noted when calculating the ranks.
  *****************************************************************************/
 void
-PointsTableProjector::dump(void)
+PointsTableProjector::dump(std::array<int, 2> const& ranks, std::vector<int> const& precedence)
 {
-    // Arrange the teams in decreasing order of points. If two have the same
-    // points, place our favourite team at the lower index.
+    // Arrange the teams in decreasing order of points. If a team has the same
+    // points as our favourite team, place our favourite team at the lower
+    // index, unless the tie-breakers say otherwise.
     std::vector<Team> teams(this->teams);
     std::sort(
         teams.rbegin(), teams.rend(),
         [&](Team const& a, Team const& b)
         {
-            return a.points < b.points || (a.points == b.points && b.tid == this->favourite_tid);
+            return a.points < b.points || (a.points == b.points && precedence[a.tid] < precedence[b.tid]);
         }
     );
-    int rank = std::find_if(
-                   teams.begin(), teams.end(),
-                   [&](Team const& t)
-                   {
-                       return t.tid == this->favourite_tid;
-                   }
-               )
-        - teams.begin() + 1;
-    std::cout << rank << '\n';
+    std::cout << ranks[0] << ' ' << ranks[1] << '\n';
     std::cout << this->box_vertical_right << this->box_horizontal << this->section_begin << "table"
               << this->section_end << '\n';
     for (Team const& team : teams)
@@ -414,6 +597,12 @@ PointsTableProjector::dump(void)
 void
 PointsTableProjector::solve(void)
 {
+    if (this->upcoming_fixtures.empty())
+    {
+        CLOG("'[upcoming]' not specified in %s.", this->fname);
+        throw std::runtime_error("parse failure");
+    }
+
     // Calculate the minimum and maximum points each team can earn.
     std::vector<std::array<int, 2>> min_max(this->teams.size());
     for (Team const& team : this->teams)
@@ -463,14 +652,27 @@ PointsTableProjector::solve(void)
  * their fixtures) starting from the specified fixture.
  *
  * @param idx Fixture index.
+ *
+ * @return Summary of the results.
  *****************************************************************************/
-void
+Summary
 PointsTableProjector::solve_(std::size_t idx)
 {
     if (idx >= this->upcoming_fixtures.size())
     {
-        this->dump();
-        return;
+        // The placement of tied teams is needed only to display the scenario.
+        std::array<int, 2> ranks = this->rank(this->show_scenarios ? &this->precedence : NULL);
+        if (this->show_scenarios)
+        {
+            this->dump(ranks, this->precedence);
+        }
+        Summary summary;
+        summary.scenarios = 1;
+        summary.qualified[0] = ranks[0] <= this->places;
+        summary.qualified[1] = ranks[1] <= this->places;
+        summary.best_rank = ranks[0];
+        summary.worst_rank = ranks[1];
+        return summary;
     }
 
     static std::random_device rdev;
@@ -487,26 +689,29 @@ PointsTableProjector::solve_(std::size_t idx)
         fixture.ordered = bgen();
         if (!fixture.ordered)
         {
-            this->solve__(idx, fixture.b, fixture.a);
+            return this->solve__(idx, fixture.b, fixture.a);
         }
-        else
-        {
-            this->solve__(idx, fixture.a, fixture.b);
-        }
-        return;
+        return this->solve__(idx, fixture.a, fixture.b);
     }
 
-    // Assume that our favourite team always wins.
+    // Assume that our favourite team always wins. Note the results which
+    // follow from each result of this fixture.
+    Summary summary;
     if (fixture.a.tid != this->favourite_tid)
     {
         fixture.ordered = false;
-        this->solve__(idx, fixture.b, fixture.a);
+        Summary summary_ = this->solve__(idx, fixture.b, fixture.a);
+        fixture.summaries[0].merge(summary_);
+        summary.merge(summary_);
     }
     if (fixture.b.tid != this->favourite_tid)
     {
         fixture.ordered = true;
-        this->solve__(idx, fixture.a, fixture.b);
+        Summary summary_ = this->solve__(idx, fixture.a, fixture.b);
+        fixture.summaries[1].merge(summary_);
+        summary.merge(summary_);
     }
+    return summary;
 }
 
 /******************************************************************************
@@ -515,13 +720,681 @@ PointsTableProjector::solve_(std::size_t idx)
  * @param idx Fixture index.
  * @param winner
  * @param loser
+ *
+ * @return Summary of the results.
  *****************************************************************************/
-void
+Summary
 PointsTableProjector::solve__(std::size_t idx, Team& winner, Team& loser)
 {
     winner.points += this->points_win;
     loser.points += this->points_loss;
-    this->solve_(idx + 1);
+    Summary summary = this->solve_(idx + 1);
     loser.points -= this->points_loss;
     winner.points -= this->points_win;
+    return summary;
+}
+
+/******************************************************************************
+ * Find how much the result of each fixture affects whether our favourite team
+ * qualifies (assuming they win all their fixtures), and display the fixtures
+ * in decreasing order of that.
+ *****************************************************************************/
+void
+PointsTableProjector::influence(void)
+{
+    if (this->places <= 0)
+    {
+        CLOG("'[places]' not specified in %s.", this->fname);
+        throw std::runtime_error("parse failure");
+    }
+
+    // The summaries of all fixtures are filled in during a single pass.
+    this->show_scenarios = false;
+    this->solve();
+
+    // Only fixtures for which both results were simulated can have any
+    // influence. (Those are the ones which neither involve our favourite team
+    // nor are inconsequential.) Both results occur in the same number of
+    // scenarios, so the difference in the number of scenarios in which our
+    // favourite team qualifies is a measure of influence.
+    std::vector<Fixture const*> fixtures;
+    for (Fixture& fixture : this->upcoming_fixtures)
+    {
+        Summary const& summary_b = fixture.summaries[0];
+        Summary const& summary_a = fixture.summaries[1];
+        if (summary_b.scenarios > 0 && summary_a.scenarios > 0)
+        {
+            for (std::size_t i = 0; i < fixture.influence.size(); ++i)
+            {
+                fixture.influence[i] = std::abs(
+                    static_cast<double>(summary_a.qualified[i]) / summary_a.scenarios
+                    - static_cast<double>(summary_b.qualified[i]) / summary_b.scenarios
+                );
+            }
+        }
+        fixtures.push_back(&fixture);
+    }
+
+    // Fixtures are compared by their influence with ties broken in favour of
+    // our favourite team, then by their influence with ties broken against
+    // it. If those are the same, the one which causes a larger change in the
+    // best and worst ranks matters more.
+    auto spread = [](Fixture const* fixture)
+    {
+        if (fixture->summaries[0].scenarios == 0 || fixture->summaries[1].scenarios == 0)
+        {
+            return 0;
+        }
+        return std::abs(fixture->summaries[1].best_rank - fixture->summaries[0].best_rank)
+            + std::abs(fixture->summaries[1].worst_rank - fixture->summaries[0].worst_rank);
+    };
+    std::stable_sort(
+        fixtures.begin(), fixtures.end(),
+        [&](Fixture const* a, Fixture const* b)
+        {
+            return a->influence > b->influence || (a->influence == b->influence && spread(a) > spread(b));
+        }
+    );
+
+    std::cout << this->box_up_right << this->box_horizontal << this->section_begin << "influence"
+              << this->section_end << '\n';
+    for (Fixture const* fixture : fixtures)
+    {
+        char const* begin = fixture->inconsequential ? this->inconsequential_begin : "";
+        char const* end = fixture->inconsequential ? this->inconsequential_end : "";
+        std::cout << "  " << begin << fixture->a.tname << ' ' << fixture->b.tname << ' ' << fixture->influence[0]
+                  << ' ' << fixture->influence[1] << end << '\n';
+        for (bool ordered : { true, false })
+        {
+            Summary const& summary = fixture->summaries[ordered];
+            if (summary.scenarios == 0)
+            {
+                continue;
+            }
+            Team const& winner = ordered ? fixture->a : fixture->b;
+            std::cout << "    " << begin << winner.tname << ' ' << summary.qualified[0] << ' ' << summary.qualified[1]
+                      << ' ' << summary.scenarios << ' ' << summary.best_rank << ' ' << summary.worst_rank << end
+                      << '\n';
+        }
+    }
+}
+
+/******************************************************************************
+ * Find the count and probability distribution of the rank of our favourite
+ * team (assuming they win all their fixtures, and that either team is equally
+ * likely to win any other fixture).
+ *****************************************************************************/
+void
+PointsTableProjector::distribute(void)
+{
+    if (this->upcoming_fixtures.empty())
+    {
+        CLOG("'[upcoming]' not specified in %s.", this->fname);
+        throw std::runtime_error("parse failure");
+    }
+
+    std::vector<int> points(this->teams.size());
+    for (Team const& team : this->teams)
+    {
+        points[team.tid] = team.points;
+    }
+    std::vector<Fixture const*> fixtures;
+    for (Fixture const& fixture : this->upcoming_fixtures)
+    {
+        fixtures.push_back(&fixture);
+    }
+    auto distribution = this->distribute_(this->favourite_tid, points, fixtures, false, true);
+    std::cout << this->box_up_right << this->box_horizontal << this->section_begin << "distribution"
+              << this->section_end << '\n';
+    for (std::size_t i = 0; i < distribution.size(); ++i)
+    {
+        if (distribution[i].first > 0)
+        {
+            std::cout << "  " << i + 1 << ' ' << distribution[i].first << ' ' << distribution[i].second << '\n';
+        }
+    }
+}
+
+/******************************************************************************
+ * Calculate the count and probability distribution of the rank of a team using
+ * dynamic programming over the fixtures. Only the teams whose position
+ * relative to the team is still unknown are tracked, so the number of states
+ * stays manageable even when enumerating all scenarios would not.
+ *
+ * @param tid Team ID.
+ * @param points Points of all teams before the fixtures are played.
+ * @param fixtures Fixtures to play.
+ * @param draws Whether the fixtures not involving the team can also be tied
+ *     or drawn or similar.
+ * @param optimistic Whether the team wins all its fixtures and is placed
+ *     highest among teams with the same points (instead of losing all its
+ *     fixtures and being placed lowest among them).
+ *
+ * @return Number of scenarios in which the team finishes at each rank, and
+ *     the probability of that, indexed from zero.
+ *****************************************************************************/
+std::vector<std::pair<long long, double>>
+PointsTableProjector::distribute_(
+    std::size_t tid, std::vector<int> const& points, std::vector<Fixture const*> const& fixtures, bool draws,
+    bool optimistic
+)
+{
+    CLOG("Calculating rank distribution of '%s'.", this->teams[tid].tname.c_str());
+
+    // The team's fixtures have a fixed result, so apply them right away. Only
+    // the remaining fixtures need to be simulated.
+    std::vector<int> state(points);
+    std::vector<Fixture const*> other_fixtures;
+    std::vector<int> remaining(this->teams.size(), 0);
+    for (Fixture const* fixture : fixtures)
+    {
+        if (fixture->a.tid == tid || fixture->b.tid == tid)
+        {
+            std::size_t other_tid = fixture->a.tid == tid ? fixture->b.tid : fixture->a.tid;
+            state[tid] += optimistic ? this->points_win : this->points_loss;
+            state[other_tid] += optimistic ? this->points_loss : this->points_win;
+        }
+        else
+        {
+            other_fixtures.push_back(fixture);
+            ++remaining[fixture->a.tid];
+            ++remaining[fixture->b.tid];
+        }
+    }
+    int team_points = state[tid];
+    int points_min = std::min(this->points_win, this->points_loss);
+    int points_max = std::max(this->points_win, this->points_loss);
+    if (draws)
+    {
+        points_min = std::min(points_min, this->points_other);
+        points_max = std::max(points_max, this->points_other);
+    }
+
+    // Points earned by the first and second teams for each result (the second
+    // team wins, the first team wins, or neither). All results are equally
+    // likely.
+    int const points_a[] = { this->points_loss, this->points_win, this->points_other };
+    int const points_b[] = { this->points_win, this->points_loss, this->points_other };
+    std::size_t results_size = draws ? 3 : 2;
+
+    // The number of scenarios may not fit. Rather than overflow, counts stop
+    // growing once they reach the largest possible value.
+    long long const count_max = std::numeric_limits<long long>::max();
+    auto add = [&](long long& count, long long addend)
+    {
+        count = count > count_max - addend ? count_max : count + addend;
+    };
+    if (other_fixtures.size() * std::log2(results_size) >= std::numeric_limits<long long>::digits)
+    {
+        CLOG("Too many fixtures to count scenarios. Only probabilities are correct.");
+    }
+
+    // A state holds the points of every team, followed by the number of teams
+    // which will finish above the team. Once it is known whether a team will
+    // finish above the team, its points no longer matter, so they are replaced
+    // with a placeholder. This allows states which differ only in the points
+    // of such teams to be merged.
+    int const settled = std::numeric_limits<int>::min();
+    auto settle = [&](std::vector<int>& state, std::size_t tid)
+    {
+        if (state[tid] == settled)
+        {
+            return;
+        }
+        int low = state[tid] + remaining[tid] * points_min;
+        int high = state[tid] + remaining[tid] * points_max;
+        if (optimistic ? low > team_points : low >= team_points)
+        {
+            state[tid] = settled;
+            ++state.back();
+        }
+        else if (optimistic ? high <= team_points : high < team_points)
+        {
+            state[tid] = settled;
+        }
+    };
+    state.push_back(0);
+    state[tid] = settled;
+    for (Team const& team : this->teams)
+    {
+        settle(state, team.tid);
+    }
+
+    // Each state is mapped to the number of scenarios which lead to it, and
+    // the probability of that.
+    std::map<std::vector<int>, std::pair<long long, double>> states { { state, { 1, 1.0 } } };
+    for (Fixture const* fixture : other_fixtures)
+    {
+        --remaining[fixture->a.tid];
+        --remaining[fixture->b.tid];
+        std::map<std::vector<int>, std::pair<long long, double>> next_states;
+        for (auto const& state_weight : states)
+        {
+            for (std::size_t i = 0; i < results_size; ++i)
+            {
+                std::vector<int> next_state(state_weight.first);
+                if (next_state[fixture->a.tid] != settled)
+                {
+                    next_state[fixture->a.tid] += points_a[i];
+                }
+                if (next_state[fixture->b.tid] != settled)
+                {
+                    next_state[fixture->b.tid] += points_b[i];
+                }
+                settle(next_state, fixture->a.tid);
+                settle(next_state, fixture->b.tid);
+                std::pair<long long, double>& next_weight = next_states[next_state];
+                add(next_weight.first, state_weight.second.first);
+                next_weight.second += state_weight.second.second / results_size;
+            }
+        }
+        states.swap(next_states);
+    }
+
+    // Every team has been settled by now.
+    std::vector<std::pair<long long, double>> distribution(this->teams.size(), { 0, 0.0 });
+    for (auto const& state_weight : states)
+    {
+        add(distribution[state_weight.first.back()].first, state_weight.second.first);
+        distribution[state_weight.first.back()].second += state_weight.second.second;
+    }
+    return distribution;
+}
+
+/******************************************************************************
+ * Replay the completed fixtures in the order they were played, and show which
+ * teams have clinched a place or been eliminated after each one.
+ *****************************************************************************/
+void
+PointsTableProjector::timeline(void)
+{
+    if (this->places <= 0)
+    {
+        CLOG("'[places]' not specified in %s.", this->fname);
+        throw std::runtime_error("parse failure");
+    }
+    if (this->completed_fixtures.empty())
+    {
+        CLOG("'[completed]' not specified in %s.", this->fname);
+        throw std::runtime_error("parse failure");
+    }
+
+    // Undo the completed fixtures to obtain the points at the start of the
+    // tournament.
+    Standings standings(this->teams.size());
+    for (Team const& team : this->teams)
+    {
+        standings.points[team.tid] = team.points;
+    }
+    std::vector<Fixture const*> fixtures;
+    for (Fixture const& fixture : this->completed_fixtures)
+    {
+        standings.points[fixture.a.tid] -= fixture.drawn ? this->points_other : this->points_win;
+        standings.points[fixture.b.tid] -= fixture.drawn ? this->points_other : this->points_loss;
+        fixtures.push_back(&fixture);
+    }
+    for (Fixture const& fixture : this->upcoming_fixtures)
+    {
+        fixtures.push_back(&fixture);
+    }
+    for (Fixture const* fixture : fixtures)
+    {
+        standings.schedule(*fixture);
+    }
+
+    std::vector<Status> statuses(this->teams.size(), undecided);
+    std::vector<Prospect> inside;
+    std::vector<Prospect> outside;
+    for (Team const& team : this->teams)
+    {
+        inside.emplace_back(team.tid, true);
+        outside.emplace_back(team.tid, false);
+    }
+    char const* status_names[] = { "undecided", "clinched", "eliminated" };
+    for (std::size_t i = 0; i < this->completed_fixtures.size(); ++i)
+    {
+        // Carry the standings over from the previous fixture.
+        Fixture const& fixture = this->completed_fixtures[i];
+        int points_a = fixture.drawn ? this->points_other : this->points_win;
+        int points_b = fixture.drawn ? this->points_other : this->points_loss;
+        standings.play(fixture, points_a, points_b);
+
+        // A team which has clinched a place or been eliminated stays that way,
+        // so only the remaining teams need to be examined.
+        for (Team const& team : this->teams)
+        {
+            if (statuses[team.tid] == undecided)
+            {
+                statuses[team.tid] = this->qualification(inside[team.tid], outside[team.tid], standings, fixtures);
+            }
+        }
+
+        std::vector<Team> teams(this->teams);
+        for (Team& team : teams)
+        {
+            team.points = standings.points[team.tid];
+        }
+        std::stable_sort(
+            teams.begin(), teams.end(),
+            [](Team const& a, Team const& b)
+            {
+                return a.points > b.points;
+            }
+        );
+        std::cout << i + 1 << '\n';
+        std::cout << this->box_vertical_right << this->box_horizontal << this->section_begin << "completed"
+                  << this->section_end << '\n';
+        std::cout << this->box_vertical << " " << fixture << '\n';
+        std::cout << this->box_up_right << this->box_horizontal << this->section_begin << "status"
+                  << this->section_end << '\n';
+        for (Team const& team : teams)
+        {
+            std::cout << "  " << team << ' ' << status_names[statuses[team.tid]] << '\n';
+        }
+    }
+}
+
+/******************************************************************************
+ * Determine whether a team has clinched a place or been eliminated.
+ *
+ * @param inside What is known about whether the team can finish inside the
+ *     qualifying places.
+ * @param outside What is known about whether the team can finish outside the
+ *     qualifying places.
+ * @param standings State of the tournament.
+ * @param fixtures Sequence of fixtures the standings refer to.
+ *
+ * @return Qualification status of the team.
+ *****************************************************************************/
+PointsTableProjector::Status
+PointsTableProjector::qualification(
+    Prospect& inside, Prospect& outside, Standings const& standings, std::vector<Fixture const*> const& fixtures
+)
+{
+    if (!this->possible(inside, standings, fixtures))
+    {
+        return eliminated;
+    }
+    if (!this->possible(outside, standings, fixtures))
+    {
+        return clinched;
+    }
+    return undecided;
+}
+
+/******************************************************************************
+ * Check whether a team can finish inside or outside the qualifying places. If
+ * it is checking the former, teams with the same points as the team are
+ * placed below it. Otherwise, they are placed above it.
+ *
+ * The scenario found the last time this was checked is reused if the fixtures
+ * played since then ended the way it says. Otherwise, a new one is searched
+ * for.
+ *
+ * @param prospect What is known about the team.
+ * @param standings State of the tournament.
+ * @param fixtures Sequence of fixtures the standings refer to.
+ *
+ * @return Whether it is possible.
+ *****************************************************************************/
+bool
+PointsTableProjector::possible(
+    Prospect& prospect, Standings const& standings, std::vector<Fixture const*> const& fixtures
+)
+{
+    // The results are numbered as in the search: a win for the first team, a
+    // win for the second team, or neither. The first team listed in a
+    // completed fixture won it unless it was drawn.
+    if (!prospect.witness.empty())
+    {
+        bool valid = true;
+        for (std::size_t i = prospect.idx; i < standings.idx && valid; ++i)
+        {
+            valid = prospect.witness[i] == (fixtures[i]->drawn ? 2 : 0);
+        }
+        if (valid)
+        {
+            prospect.idx = standings.idx;
+            return true;
+        }
+    }
+
+    // The number of partial scenarios grows exponentially with the number of
+    // remaining fixtures. Rather than run for ever, stop after a while and
+    // leave the team undecided.
+    Standings search_standings(standings);
+    long long budget = 1LL << 18;
+    prospect.witness.assign(fixtures.size(), 0);
+    prospect.idx = standings.idx;
+    if (!this->search(prospect, search_standings, fixtures, budget))
+    {
+        prospect.witness.clear();
+        return false;
+    }
+    if (budget < 0)
+    {
+        CLOG(
+            "Could not determine whether '%s' can finish %s the qualifying places after %zu matches.",
+            this->teams[prospect.tid].tname.c_str(), prospect.qualified ? "inside" : "outside", standings.idx
+        );
+        prospect.witness.clear();
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Search for a scenario in which a team finishes inside or outside the
+ * qualifying places, assuming that it wins or loses (respectively) all its
+ * remaining fixtures. The remaining fixtures are decided one at a time. A
+ * partial scenario is abandoned as soon as the points show that it cannot be
+ * completed, or if it is equivalent to one abandoned earlier.
+ *
+ * @param prospect What is known about the team. The scenario is written into
+ *     it if one is found.
+ * @param standings State of the tournament. (It is modified while searching,
+ *     but restored before returning.)
+ * @param fixtures Sequence of fixtures the standings refer to.
+ * @param budget Number of partial scenarios which may still be examined. If
+ *     it runs out, the search stops as if a scenario had been found.
+ *
+ * @return Whether a scenario was found.
+ *****************************************************************************/
+bool
+PointsTableProjector::search(
+    Prospect& prospect, Standings& standings, std::vector<Fixture const*> const& fixtures, long long& budget
+)
+{
+    if (--budget < 0)
+    {
+        return true;
+    }
+    std::size_t tid = prospect.tid;
+    bool qualified = prospect.qualified;
+    int points_min = std::min({ this->points_win, this->points_loss, this->points_other });
+    int points_max = std::max({ this->points_win, this->points_loss, this->points_other });
+    int team_points
+        = standings.points[tid] + standings.remaining[tid] * (qualified ? this->points_win : this->points_loss);
+    auto above = [&](int points)
+    {
+        return qualified ? points > team_points : points >= team_points;
+    };
+    auto success = [&](int above_count)
+    {
+        return qualified ? above_count < this->places : above_count >= this->places;
+    };
+
+    // Count the teams which will certainly finish above the team, and those
+    // which may. The position of a team relative to the team cannot change
+    // once it is known, so its points are irrelevant from then on. Replace
+    // them with a marker, so that more partial scenarios are equivalent.
+    std::vector<int> key(standings.points);
+    key.push_back(standings.idx);
+    int certain_count = 0;
+    int possible_count = 0;
+    // Also add up the points of the other teams, and the most (or least)
+    // points they can finish with if the team is to finish inside (or
+    // outside), given that only the teams chosen to finish above it do.
+    // How many points each contender (a team whose position relative to the
+    // team is not yet known) adds to that if chosen is noted separately.
+    int fixtures_count = 0;
+    int points_sum = 0;
+    int bound_sum = 0;
+    std::vector<std::pair<int, std::size_t>> margins;
+    for (Team const& team : this->teams)
+    {
+        if (team.tid == tid)
+        {
+            continue;
+        }
+        int between = standings.between[tid][team.tid];
+        int others = standings.remaining[team.tid] - between;
+        int points = standings.points[team.tid] + between * (qualified ? this->points_loss : this->points_win);
+        int points_low = points + others * points_min;
+        int points_high = points + others * points_max;
+        bool certain = above(points_low);
+        bool possible = above(points_high);
+        certain_count += certain;
+        possible_count += possible;
+        if (certain == possible)
+        {
+            key[team.tid] = certain ? std::numeric_limits<int>::max() : std::numeric_limits<int>::min();
+        }
+        fixtures_count += others;
+        points_sum += points;
+        if (qualified)
+        {
+            bound_sum += certain ? points_high : std::min(points_high, team_points);
+        }
+        else
+        {
+            bound_sum += points_low;
+        }
+        if (certain != possible)
+        {
+            margins.emplace_back(qualified ? points_high - team_points : team_points - points_low, team.tid);
+        }
+    }
+    if (success(certain_count) && success(possible_count))
+    {
+        for (std::size_t i = standings.idx; i < fixtures.size(); ++i)
+        {
+            prospect.witness[i] = (fixtures[i]->a.tid == tid) == qualified ? 0 : 1;
+        }
+        return true;
+    }
+    if (!success(certain_count) && !success(possible_count))
+    {
+        return false;
+    }
+
+    // The points earned in the remaining fixtures not involving the team must
+    // be shared among the other teams. If the team is to finish inside, at
+    // most this many contenders may finish above it, so the ones which can
+    // take the most points should be chosen to. Otherwise, at least this many
+    // must, so the ones which need the fewest points should be chosen.
+    int chosen = this->places - certain_count - (qualified ? 1 : 0);
+    if (qualified)
+    {
+        std::partial_sort(
+            margins.begin(), margins.begin() + chosen, margins.end(), std::greater<std::pair<int, std::size_t>>()
+        );
+    }
+    else
+    {
+        std::partial_sort(margins.begin(), margins.begin() + chosen, margins.end());
+    }
+    for (int i = 0; i < chosen; ++i)
+    {
+        bound_sum += margins[i].first;
+    }
+    int total_min = std::min(this->points_win + this->points_loss, 2 * this->points_other);
+    int total_max = std::max(this->points_win + this->points_loss, 2 * this->points_other);
+    if (qualified ? points_sum + fixtures_count / 2 * total_min > bound_sum
+                  : points_sum + fixtures_count / 2 * total_max < bound_sum)
+    {
+        return false;
+    }
+    if (prospect.dead_ends.count(key) == 1)
+    {
+        return false;
+    }
+
+    // Try the results of the next fixture, most promising first. The chosen
+    // contenders should win as often as possible. If the team is to finish
+    // inside, the other contenders should lose as often as possible.
+    // Otherwise, they don't matter as much as the chosen ones, but more than
+    // the teams whose position is known. Among equals, the team which is
+    // further below the points of the team (allowing for the points it is
+    // expected to earn in its other remaining fixtures) should win. The
+    // result does not matter if neither team is a contender.
+    auto eagerness = [&](std::size_t tid)
+    {
+        if (key[tid] != standings.points[tid])
+        {
+            return qualified ? 1 : 0;
+        }
+        for (int i = 0; i < chosen; ++i)
+        {
+            if (margins[i].second == tid)
+            {
+                return 2;
+            }
+        }
+        return qualified ? 0 : 1;
+    };
+    auto room = [&](std::size_t tid)
+    {
+        int between = standings.between[prospect.tid][tid];
+        int points = standings.points[tid] + between * (qualified ? this->points_loss : this->points_win);
+        int others = standings.remaining[tid] - between;
+        return 2 * (team_points - points) - others * (this->points_win + this->points_loss);
+    };
+    Fixture const* fixture = fixtures[standings.idx];
+    std::array<std::array<int, 2>, 3> results = { {
+        { this->points_win, this->points_loss },
+        { this->points_loss, this->points_win },
+        { this->points_other, this->points_other },
+    } };
+    std::array<int, 3> order;
+    std::size_t order_size = 1;
+    if (fixture->a.tid == tid || fixture->b.tid == tid)
+    {
+        order[0] = (fixture->a.tid == tid) == qualified ? 0 : 1;
+    }
+    else
+    {
+        int a_eagerness = eagerness(fixture->a.tid);
+        int b_eagerness = eagerness(fixture->b.tid);
+        bool ordered = a_eagerness > b_eagerness
+            || (a_eagerness == b_eagerness && room(fixture->a.tid) >= room(fixture->b.tid));
+        order[0] = ordered ? 0 : 1;
+        if (key[fixture->a.tid] == standings.points[fixture->a.tid]
+            || key[fixture->b.tid] == standings.points[fixture->b.tid])
+        {
+            order[1] = 2;
+            order[2] = ordered ? 1 : 0;
+            order_size = 3;
+        }
+    }
+    for (std::size_t i = 0; i < order_size; ++i)
+    {
+        std::array<int, 2> const& result = results[order[i]];
+        standings.play(*fixture, result[0], result[1]);
+        bool found = this->search(prospect, standings, fixtures, budget);
+        standings.undo(*fixture, result[0], result[1]);
+        if (found)
+        {
+            prospect.witness[standings.idx] = order[i];
+            return true;
+        }
+    }
+
+    // Remember that this partial scenario cannot be completed, but forget all
+    // the others if too many have been remembered.
+    if (prospect.dead_ends.size() >= 1U << 16)
+    {
+        prospect.dead_ends.clear();
+    }
+    prospect.dead_ends.insert(key);
+    return false;
 }
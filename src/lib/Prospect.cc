@@ -0,0 +1,14 @@
+#include <cstddef>
+
+#include "Prospect.hh"
+
+/******************************************************************************
+ * Constructor.
+ *
+ * @param tid Team ID.
+ * @param qualified Whether this is about finishing inside the qualifying
+ *     places (instead of outside).
+ *****************************************************************************/
+Prospect::Prospect(std::size_t tid, bool qualified) : tid(tid), qualified(qualified), idx(0)
+{
+}
@@ -0,0 +1,67 @@
+#include <cstddef>
+#include <vector>
+
+#include "Fixture.hh"
+#include "Standings.hh"
+
+/******************************************************************************
+ * Constructor.
+ *
+ * @param teams_size Number of teams.
+ *****************************************************************************/
+Standings::Standings(std::size_t teams_size) :
+    points(teams_size, 0), remaining(teams_size, 0), between(teams_size, std::vector<int>(teams_size, 0)), idx(0)
+{
+}
+
+/******************************************************************************
+ * Add a fixture to the end of the sequence.
+ *
+ * @param fixture
+ *****************************************************************************/
+void
+Standings::schedule(Fixture const& fixture)
+{
+    ++this->remaining[fixture.a.tid];
+    ++this->remaining[fixture.b.tid];
+    ++this->between[fixture.a.tid][fixture.b.tid];
+    ++this->between[fixture.b.tid][fixture.a.tid];
+}
+
+/******************************************************************************
+ * Play the first remaining fixture in the sequence.
+ *
+ * @param fixture
+ * @param points_a Points earned by the first team.
+ * @param points_b Points earned by the second team.
+ *****************************************************************************/
+void
+Standings::play(Fixture const& fixture, int points_a, int points_b)
+{
+    this->points[fixture.a.tid] += points_a;
+    this->points[fixture.b.tid] += points_b;
+    --this->remaining[fixture.a.tid];
+    --this->remaining[fixture.b.tid];
+    --this->between[fixture.a.tid][fixture.b.tid];
+    --this->between[fixture.b.tid][fixture.a.tid];
+    ++this->idx;
+}
+
+/******************************************************************************
+ * Take back the last fixture played.
+ *
+ * @param fixture
+ * @param points_a Points earned by the first team.
+ * @param points_b Points earned by the second team.
+ *****************************************************************************/
+void
+Standings::undo(Fixture const& fixture, int points_a, int points_b)
+{
+    this->points[fixture.a.tid] -= points_a;
+    this->points[fixture.b.tid] -= points_b;
+    ++this->remaining[fixture.a.tid];
+    ++this->remaining[fixture.b.tid];
+    ++this->between[fixture.a.tid][fixture.b.tid];
+    ++this->between[fixture.b.tid][fixture.a.tid];
+    --this->idx;
+}
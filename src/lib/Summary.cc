@@ -0,0 +1,28 @@
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "Summary.hh"
+
+/******************************************************************************
+ * Constructor.
+ *****************************************************************************/
+Summary::Summary(void) :
+    scenarios(0), qualified(), best_rank(std::numeric_limits<int>::max()), worst_rank(std::numeric_limits<int>::min())
+{
+}
+
+/******************************************************************************
+ * Include another group of scenarios in this one.
+ *
+ * @param summary
+ *****************************************************************************/
+void
+Summary::merge(Summary const& summary)
+{
+    this->scenarios += summary.scenarios;
+    this->qualified[0] += summary.qualified[0];
+    this->qualified[1] += summary.qualified[1];
+    this->best_rank = std::min(this->best_rank, summary.best_rank);
+    this->worst_rank = std::max(this->worst_rank, summary.worst_rank);
+}
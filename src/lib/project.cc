@@ -19,6 +19,9 @@ main(int const argc, char const* argv[])
     // is where logging messages go in the rest of this project.
     char const* fname = NULL;
     bool raw_output = false;
+    bool head_to_head = false;
+    // Option selecting what to display (if any).
+    char const* mode = NULL;
     for (int i = 1; i < argc; ++i)
     {
         if (argv[i][0] != '-')
@@ -36,6 +39,22 @@ main(int const argc, char const* argv[])
             raw_output = true;
             continue;
         }
+        if (std::strcmp(argv[i], "--distribution") == 0 || std::strcmp(argv[i], "--timeline") == 0
+            || std::strcmp(argv[i], "--influence") == 0)
+        {
+            if (mode != NULL && std::strcmp(mode, argv[i]) != 0)
+            {
+                std::fprintf(stderr, "Options '%s' and '%s' cannot be used together.\n", mode, argv[i]);
+                return EXIT_FAILURE;
+            }
+            mode = argv[i];
+            continue;
+        }
+        if (std::strcmp(argv[i], "--head-to-head") == 0)
+        {
+            head_to_head = true;
+            continue;
+        }
         std::fprintf(stderr, "Unknown option: '%s'.\n", argv[i]);
         return EXIT_FAILURE;
     }
@@ -44,6 +63,32 @@ main(int const argc, char const* argv[])
         std::fprintf(stderr, "Input file not specified.\n");
         return EXIT_FAILURE;
     }
+    // The rank distribution and the timeline place teams with the same points
+    // above or below a team without consulting the tie-breakers.
+    if (head_to_head && mode != NULL && std::strcmp(mode, "--influence") != 0)
+    {
+        std::fprintf(stderr, "Options '%s' and '%s' cannot be used together.\n", mode, "--head-to-head");
+        return EXIT_FAILURE;
+    }
     PointsTableProjector projector(fname, raw_output);
-    projector.solve();
+    if (head_to_head)
+    {
+        projector.add_head_to_head();
+    }
+    if (mode == NULL)
+    {
+        projector.solve();
+    }
+    else if (std::strcmp(mode, "--distribution") == 0)
+    {
+        projector.distribute();
+    }
+    else if (std::strcmp(mode, "--timeline") == 0)
+    {
+        projector.timeline();
+    }
+    else
+    {
+        projector.influence();
+    }
 }